@@ -0,0 +1,166 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Ensemble chorus: three modulated taps per channel read from one delay line,
+// with a single LFO phase shared by every tap (taps sit a third of a cycle
+// apart, the right channel a quarter cycle further on).
+//
+// The LFO is only evaluated at chunk boundaries and the delay of each tap is
+// ramped linearly in between. The delay line is stored twice back to back, so
+// a read at (write position + size - delay) never wraps. The delay is always
+// longer than a chunk, so every read in a chunk sees samples written before it.
+// That keeps the tap loops branch-free and lets the whole chunk be read before
+// any of it is written.
+//
+// Rate, depth, centre delay and feedback only recompute on an actual change.
+// When the mix has settled at 0 the engine does nothing at all.
+template <typename FloatType>
+struct ChorusEngine
+{
+    static constexpr int numTaps = 3;
+    static constexpr int maxChannels = 2;
+    static constexpr int chunkSize = 64;
+    static constexpr double maxDelayMs = 20.0;
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = juce::jmin((int) spec.numChannels, maxChannels);
+
+        const int needed = (int) std::ceil(maxDelayMs * 0.001 * sampleRate) + chunkSize + 2;
+        size = juce::nextPowerOfTwo(needed);
+        line.setSize(numChannels, 2 * size, false, false, true);
+
+        mix.reset(sampleRate, 0.05);
+        updateModulation();
+        reset();
+    }
+
+    void reset()
+    {
+        line.clear();
+        writePos = 0;
+        lfoPhase = 0.0;
+        mix.setCurrentAndTargetValue(mix.getTargetValue());
+        evaluateLfo(lfoPhase, lfoDelay);
+    }
+
+    //==============================================================================
+    void setMix(FloatType newMix)
+    {
+        if (newMix == mix.getTargetValue()) return;
+
+        // The line stopped being written while bypassed; start again from silence
+        if (isBypassed())
+            line.clear();
+
+        mix.setTargetValue(newMix);
+    }
+
+    void setRate(double hz)          { if (hz != rateHz)        { rateHz = hz;        updateModulation(); } }
+    void setDepth(double d)          { if (d != depth)          { depth = d;          updateModulation(); } }
+    void setCentreDelay(double ms)   { if (ms != centreMs)      { centreMs = ms;      updateModulation(); } }
+    void setFeedback(FloatType fb)   { feedback = juce::jlimit((FloatType) -0.95, (FloatType) 0.95, fb); }
+
+    // True bypass: nothing is read, written or mixed
+    bool isBypassed() const { return mix.getTargetValue() == 0 && ! mix.isSmoothing(); }
+
+    //==============================================================================
+    void process(juce::AudioBuffer<FloatType>& buffer)
+    {
+        if (isBypassed()) return;
+
+        const int n = buffer.getNumSamples();
+        const int chans = juce::jmin(numChannels, buffer.getNumChannels());
+        const FloatType tapGain = FloatType(1) / (FloatType) numTaps;
+
+        for (int start = 0; start < n; start += chunkSize)
+        {
+            const int len = juce::jmin(chunkSize, n - start);
+            const FloatType invLen = FloatType(1) / (FloatType) len;
+
+            // Shared LFO at the end of this chunk; delays ramp towards it
+            const double nextPhase = wrap(lfoPhase + lfoIncrement * len);
+            FloatType nextDelay[maxChannels][numTaps];
+            evaluateLfo(nextPhase, nextDelay);
+
+            FloatType mixRamp[chunkSize];
+            for (int i = 0; i < len; ++i)
+                mixRamp[i] = mix.getNextValue();
+
+            for (int ch = 0; ch < chans; ++ch)
+            {
+                FloatType wet[chunkSize] {};
+                const FloatType* src = line.getReadPointer(ch);
+
+                for (int t = 0; t < numTaps; ++t)
+                {
+                    const FloatType d0 = lfoDelay[ch][t];
+                    const FloatType step = (nextDelay[ch][t] - d0) * invLen;
+                    const FloatType base = (FloatType) (writePos + size) - d0;
+
+                    for (int i = 0; i < len; ++i)
+                    {
+                        const FloatType pos = base + (FloatType) i * (1 - step);
+                        const int idx = (int) pos;
+                        const FloatType frac = pos - (FloatType) idx;
+                        wet[i] += src[idx] + frac * (src[idx + 1] - src[idx]);
+                    }
+                }
+
+                FloatType* dst = line.getWritePointer(ch);
+                FloatType* io = buffer.getWritePointer(ch, start);
+
+                for (int i = 0; i < len; ++i)
+                {
+                    const FloatType w = wet[i] * tapGain;
+                    const int p = (writePos + i) & (size - 1);
+                    dst[p] = dst[p + size] = io[i] - feedback * w;   // subtracted, as juce::dsp::Chorus
+                    io[i] += (w - io[i]) * mixRamp[i];
+                }
+            }
+
+            writePos = (writePos + len) & (size - 1);
+            lfoPhase = nextPhase;
+            std::copy(&nextDelay[0][0], &nextDelay[0][0] + maxChannels * numTaps, &lfoDelay[0][0]);
+        }
+    }
+
+private:
+    static double wrap(double phase) { return phase - std::floor(phase); }
+
+    // Delay in samples of every tap at the given LFO phase
+    void evaluateLfo(double phase, FloatType (&delays)[maxChannels][numTaps]) const
+    {
+        for (int ch = 0; ch < maxChannels; ++ch)
+            for (int t = 0; t < numTaps; ++t)
+            {
+                const double p = phase + (double) t / numTaps + 0.25 * ch;
+                delays[ch][t] = (FloatType) (centreSamples + modSamples * std::sin(juce::MathConstants<double>::twoPi * p));
+            }
+    }
+
+    void updateModulation()
+    {
+        if (sampleRate <= 0.0) return;
+
+        // Keep every tap between one chunk (so a chunk never reads its own writes) and the line length
+        const double minDelay = chunkSize + 2.0;
+        const double maxDelay = (double) (size - chunkSize - 2);
+        centreSamples = juce::jlimit(minDelay, maxDelay, centreMs * 0.001 * sampleRate);
+        modSamples = juce::jmin(depth * 0.010 * sampleRate,   // depth 1 = +/-10 ms, as juce::dsp::Chorus
+                                centreSamples - minDelay, maxDelay - centreSamples);
+        lfoIncrement = rateHz / sampleRate;
+        evaluateLfo(lfoPhase, lfoDelay);
+    }
+
+    juce::AudioBuffer<FloatType> line;   // [0, size) and [size, 2 * size) hold the same samples
+    int size = 0, writePos = 0, numChannels = 0;
+    double sampleRate = 0.0;
+
+    double rateHz = 0.25, depth = 0.5, centreMs = 7.0;
+    double centreSamples = 0.0, modSamples = 0.0, lfoIncrement = 0.0, lfoPhase = 0.0;
+    FloatType lfoDelay[maxChannels][numTaps] {};
+    FloatType feedback = (FloatType) 0.1;
+    juce::SmoothedValue<FloatType> mix { 0 };
+};
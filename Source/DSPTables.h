@@ -0,0 +1,159 @@
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+#include <mutex>
+
+// Immutable sample-rate-dependent lookup tables. One set per rate is shared by
+// every voice and every plugin instance in the process: it is built on first
+// use by DSPTables::get() and freed when the last holder lets go of it.
+struct DSPTables
+{
+    static constexpr int tableSize = 2048;          // samples per wavetable cycle (power of two)
+    static constexpr int numMips = 10;              // one per octave
+    static constexpr double mipBaseHz = 40.0;       // highest fundamental of mip 0
+    static constexpr float cutoffMinHz = 20.0f;
+    static constexpr int cutoffOctaves = 10;        // 20 Hz .. 20480 Hz
+    static constexpr int cutoffStepsPerOctave = 96;
+
+    static std::shared_ptr<const DSPTables> get(double sampleRate)
+    {
+        static std::mutex lock;
+        static std::map<double, std::weak_ptr<const DSPTables>> cache;
+
+        std::lock_guard<std::mutex> sl(lock);
+
+        for (auto it = cache.begin(); it != cache.end();)
+            it = it->second.expired() ? cache.erase(it) : std::next(it);
+
+        auto& slot = cache[sampleRate];
+        if (auto existing = slot.lock())
+            return existing;
+
+        auto tables = std::make_shared<const DSPTables>(sampleRate);
+        slot = tables;
+        return tables;
+    }
+
+    explicit DSPTables(double sr)
+        : sampleRate(sr),
+          sine((size_t) tableSize + 1),
+          sawMips((size_t) (numMips * (tableSize + 1))),
+          squareMips((size_t) (numMips * (tableSize + 1))),
+          cutoffG((size_t) (cutoffOctaves * cutoffStepsPerOctave + 1))
+    {
+        // Pitch -> phase increment in cycles per sample
+        for (int n = 0; n < 128; ++n)
+            noteIncrement[(size_t) n] = juce::MidiMessage::getMidiNoteInHertz(n) / sr;
+
+        for (int i = 0; i <= tableSize; ++i)
+            sine[(size_t) i] = (float) std::sin(juce::MathConstants<double>::twoPi * i / tableSize);
+
+        // Band-limited saw/square. Higher mips keep fewer harmonics, so the sums are built
+        // once from the lowest harmonic count upwards and snapshotted per mip.
+        std::vector<float> saw((size_t) tableSize, 0.0f), square((size_t) tableSize, 0.0f);
+        int k = 0;
+        for (int m = numMips - 1; m >= 0; --m)
+        {
+            const int harmonics = juce::jlimit(1, tableSize / 2 - 1,
+                                               (int) (0.5 * sr / (mipBaseHz * std::pow(2.0, m))));
+            while (k < harmonics)
+            {
+                ++k;
+                const float a = 1.0f / (float) k;
+                const bool odd = (k & 1) != 0;
+                for (int i = 0; i < tableSize; ++i)
+                {
+                    const float h = sine[(size_t) ((k * i) & (tableSize - 1))] * a;
+                    saw[(size_t) i] -= h;
+                    if (odd) square[(size_t) i] += h;
+                }
+            }
+
+            auto* sawDst = sawMips.data() + m * (tableSize + 1);
+            auto* sqDst  = squareMips.data() + m * (tableSize + 1);
+            for (int i = 0; i < tableSize; ++i)
+            {
+                sawDst[i] = saw[(size_t) i] * (2.0f / juce::MathConstants<float>::pi);
+                sqDst[i]  = square[(size_t) i] * (4.0f / juce::MathConstants<float>::pi);
+            }
+            sawDst[tableSize] = sawDst[0];
+            sqDst[tableSize]  = sqDst[0];
+        }
+
+        // TPT filter prewarp g = tan(pi * fc / sr), log-spaced from 20 Hz, capped below Nyquist
+        for (size_t j = 0; j < cutoffG.size(); ++j)
+        {
+            auto hz = cutoffMinHz * std::pow(2.0, (double) j / cutoffStepsPerOctave);
+            hz = juce::jmin(hz, sr * 0.49);
+            cutoffG[j] = (float) std::tan(juce::MathConstants<double>::pi * hz / sr);
+        }
+    }
+
+    // Mip whose harmonics stay below Nyquist for the given increment (cycles per sample)
+    int mipForIncrement(double inc) const
+    {
+        auto hz = inc * sampleRate;
+        if (hz <= mipBaseHz) return 0;
+        return juce::jlimit(0, numMips - 1, (int) std::ceil(std::log2(hz / mipBaseHz)));
+    }
+
+    const float* sawMip(int mip) const    { return sawMips.data() + mip * (tableSize + 1); }
+    const float* squareMip(int mip) const { return squareMips.data() + mip * (tableSize + 1); }
+
+    // Linear lookup; phase in [0, 1). Interpolates in the caller's sample type.
+    template <typename FloatType = float>
+    static inline FloatType read(const float* table, double phase)
+    {
+        auto pos = phase * tableSize;
+        auto whole = (int) pos;
+        auto frac = (FloatType) (pos - whole);
+        auto i = whole & (tableSize - 1);
+        return (FloatType) table[i] + frac * (FloatType) (table[i + 1] - table[i]);
+    }
+
+    // g for a cutoff given in octaves above cutoffMinHz
+    inline float cutoffToG(float octaves) const
+    {
+        auto pos = juce::jlimit(0.0f, (float) cutoffOctaves, octaves) * (float) cutoffStepsPerOctave;
+        auto i = juce::jmin((int) pos, (int) cutoffG.size() - 2);
+        auto frac = pos - (float) i;
+        return cutoffG[(size_t) i] + frac * (cutoffG[(size_t) i + 1] - cutoffG[(size_t) i]);
+    }
+
+    const double sampleRate;
+    std::array<double, 128> noteIncrement {};
+    std::vector<float> sine, sawMips, squareMips, cutoffG;
+};
+
+// tanh lookup for the drive and soft-clip stages. It does not depend on the sample
+// rate, so a single table is built once per process.
+struct TanhTable
+{
+    static constexpr float range = 5.0f;  // tanh(5) is within 1e-4 of 1
+    static constexpr int size = 4096;
+
+    static const TanhTable& get()
+    {
+        static const TanhTable table;
+        return table;
+    }
+
+    template <typename FloatType>
+    inline FloatType operator()(FloatType x) const
+    {
+        auto pos = (juce::jlimit((FloatType) -range, (FloatType) range, x) + (FloatType) range) * (FloatType) scale;
+        auto i = juce::jmin((int) pos, size - 1);
+        auto frac = pos - (FloatType) i;
+        return (FloatType) values[(size_t) i] + frac * (FloatType) (values[(size_t) i + 1] - values[(size_t) i]);
+    }
+
+private:
+    TanhTable()
+    {
+        for (int i = 0; i <= size; ++i)
+            values[(size_t) i] = std::tanh((float) i / scale - range);
+    }
+
+    static constexpr float scale = (float) size / (2.0f * range);
+    std::array<float, size + 1> values {};
+};
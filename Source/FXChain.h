@@ -1,102 +1,230 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "DSPTables.h"
+#include "ChorusEngine.h"
 
+// Master FX, instantiated for float and double processing. Everything runs in the
+// sample type except juce::dsp::Reverb, which only exists for float: the double
+// chain feeds it 100% wet through a float scratch buffer and mixes the dry signal
+// itself, so only the reverb tail is ever rounded to float.
+template <typename FloatType>
 struct FXChain
 {
+    // Stages that were allocated before keep their buffers (JUCE only reallocates when a
+    // size grows); stages that were never enabled stay empty until allocateStages().
     void prepare(double sr, int block, int channels)
     {
-        juce::dsp::ProcessSpec s { sr, (juce::uint32) block, (juce::uint32) channels };
-        chorus.prepare(s);
-        reverb.prepare(s);
-        crusher.prepare(s);
-        comp.prepare(s);
+        spec = { sr, (juce::uint32) block, (juce::uint32) channels };
+        comp.prepare(spec);
 
-        // Delay (simple)
-        delayLine.reset();
-        delayLine.setMaximumDelayInSamples((int)(sr * 2.0));
+        chorus.setRate(0.25);
+        chorus.setDepth(0.5);
+        chorus.setCentreDelay(7.0);
+        chorus.setFeedback((FloatType) 0.1);
+
+        if (chorusReady.load()) chorus.prepare(spec);
+        if (reverbReady.load()) prepareReverb();
+        if (delayReady.load())  prepareDelay();
+
+        for (int i = 1; i < 3; ++i)
+            if (crushOS[i] != nullptr)
+                allocateOversampling(i);
+
+        reverbDry.reset(sr, 0.01);   // same ramp juce::Reverb uses for its own dry gain
         mixSmoothed.reset(sr, 0.05);
         widthSmoothed.reset(sr, 0.05);
-        comp.setRatio(2.0f);
-        comp.setThreshold(-12.0f);
-        comp.setAttack(10.0f);
-        comp.setRelease(100.0f);
+        comp.setRatio(2);
+        comp.setThreshold(-12);
+        comp.setAttack(10);
+        comp.setRelease(100);
     }
 
-    void setParams(float chorusMix, float delayTimeMs, float delayFb, float delayMix,
-                   float reverbMix, float crushAmt, float compAmt, float width, bool limitOn)
+    // Allocates enabled stages on first use. Realtime processing skips a stage until its
+    // ready flag is set, so this only runs on the audio thread for offline renders.
+    void allocateStages(float chorusMix, float reverbMix, float delayMix)
     {
-        this->limitOn = limitOn;
-        mixSmoothed.setTargetValue(delayMix);
-        widthSmoothed.setTargetValue(width);
+        if (spec.sampleRate <= 0.0) return;
 
-        // Chorus
-        chorus.setMix(juce::jlimit(0.0f, 1.0f, chorusMix));
-        chorus.setDepth(0.5f);
-        chorus.setCentreDelay(7.0f);
-        chorus.setFeedback(0.1f);
-        chorus.setRate(0.25f);
+        if (chorusMix > 0.0f && ! chorusReady.load()) { chorus.prepare(spec); chorusReady = true; }
+        if (reverbMix > 0.0f && ! reverbReady.load()) { setReverbParams(reverbMix); prepareReverb(); reverbReady = true; }
+        if (delayMix  > 0.0f && ! delayReady.load())  { prepareDelay();       delayReady = true; }
+    }
+
+    // Oversamplers for the crusher and soft clip (index 1 = 2x, 2 = 4x). Same threading
+    // rule as allocateStages(); the caller only selects the index once this has run.
+    void allocateOversampling(int index)
+    {
+        if (crushOS[index] == nullptr)
+        {
+            crushOS[index] = std::make_unique<juce::dsp::Oversampling<FloatType>>((size_t) spec.numChannels, (size_t) index,
+                juce::dsp::Oversampling<FloatType>::filterHalfBandPolyphaseIIR, true);
+            clipOS[index] = std::make_unique<juce::dsp::Oversampling<FloatType>>((size_t) spec.numChannels, (size_t) index,
+                juce::dsp::Oversampling<FloatType>::filterHalfBandPolyphaseIIR, true);
+        }
 
-        // Reverb
+        crushOS[index]->initProcessing((size_t) spec.maximumBlockSize);
+        clipOS[index]->initProcessing((size_t) spec.maximumBlockSize);
+    }
+
+    void prepareDelay()
+    {
+        delayLine.setMaximumDelayInSamples((int) (spec.sampleRate * 2.0));
+        delayLine.prepare(spec);
+    }
+
+    void setReverbParams(float reverbMix)
+    {
         juce::dsp::Reverb::Parameters rp;
         rp.roomSize = 0.45f;
         rp.wetLevel = juce::jlimit(0.0f, 1.0f, reverbMix);
         rp.dryLevel = 1.0f - rp.wetLevel;
         rp.width = 1.0f;
         rp.damping = 0.35f;
+        if constexpr (! std::is_same_v<FloatType, float>)
+        {
+            reverbDry.setTargetValue((FloatType) (rp.dryLevel * reverbDryScale));
+            rp.dryLevel = 0.0f;
+        }
         reverb.setParameters(rp);
+    }
+
+    void prepareReverb()
+    {
+        reverb.prepare(spec);   // also snaps its parameter smoothing to the values just set
+        if constexpr (! std::is_same_v<FloatType, float>)
+        {
+            reverbScratch.setSize((int) spec.numChannels, (int) spec.maximumBlockSize, false, false, true);
+            reverbDry.setCurrentAndTargetValue(reverbDry.getTargetValue());
+        }
+    }
+
+    void setParams(float chorusMix, float delayTimeMs, float delayFb, float delayMix,
+                   float reverbMix, float crushAmt, float compAmt, float width, bool limitOn)
+    {
+        this->limitOn = limitOn;
+        mixSmoothed.setTargetValue((FloatType) delayMix);
+        widthSmoothed.setTargetValue((FloatType) width);
+
+        // Chorus (rate, depth and delay are fixed in prepare)
+        if (chorusReady.load())
+            chorus.setMix((FloatType) juce::jlimit(0.0f, 1.0f, chorusMix));
+
+        // Reverb (not touched until allocated, prepare may be running on another thread)
+        if (reverbReady.load())
+            setReverbParams(reverbMix);
 
         // Crusher (simple)
-        crushSteps = juce::jmap(crushAmt, 0.0f, 1.0f, 0.0f, 64.0f);
+        crushSteps = (FloatType) juce::jmap(crushAmt, 0.0f, 1.0f, 0.0f, 64.0f);
 
         // Delay
-        delaySamples = (int) juce::jlimit(1.0f, 2.0f * 48000.0f, delayTimeMs * 48.0f); // up to 2s @48k
-        delayFeedback = juce::jlimit(0.0f, 0.95f, delayFb);
+        auto srMs = (float) spec.sampleRate * 0.001f;
+        delaySamples = (int) juce::jlimit(1.0f, 2000.0f * srMs, delayTimeMs * srMs); // up to 2s
+        delayFeedback = (FloatType) juce::jlimit(0.0f, 0.95f, delayFb);
 
         // Comp amount maps to makeup via output stage
-        compMakeup = juce::Decibels::decibelsToGain(juce::jmap(compAmt, 0.0f, 1.0f, 0.0f, 6.0f));
+        compMakeup = (FloatType) juce::Decibels::decibelsToGain(juce::jmap(compAmt, 0.0f, 1.0f, 0.0f, 6.0f));
     }
 
-    inline float processSample(int ch, float x)
+    // 0 = off, 1 = 2x, 2 = 4x. Only the crusher and soft clip run oversampled.
+    void setOversampling(int index)
     {
-        // Width (mid/side matrix)
-        float w = widthSmoothed.getNextValue(); // 0..1
-        // We'll apply width later on stereo buffer; here pass-through for mono path
-        float y = x;
+        index = juce::jlimit(0, 2, index);
+        if (index == osIndex) return;
 
-        // Bitcrusher (staircase quantize)
-        if (crushSteps > 1.0f)
+        osIndex = index;
+        if (osIndex > 0)
         {
-            float step = 2.0f / crushSteps;
-            y = std::floor((y + 1.0f) / step) * step - 1.0f;
+            crushOS[osIndex]->reset();
+            clipOS[osIndex]->reset();
         }
+    }
 
+    // Delay added by the selected oversamplers, in samples at the base rate
+    FloatType getLatencyInSamples() const
+    {
+        return osIndex > 0 ? crushOS[osIndex]->getLatencyInSamples() + clipOS[osIndex]->getLatencyInSamples() : 0;
+    }
+
+    inline FloatType processSample(int ch, FloatType x)
+    {
         // Delay
-        float delayed = delayLine.popSample(ch);
-        float toDelay = y + delayed * delayFeedback;
+        FloatType delayed = delayLine.popSample(ch);
+        delayPeak = juce::jmax(delayPeak, (float) std::abs(delayed));
+        FloatType toDelay = x + delayed * delayFeedback;
         delayLine.pushSample(ch, toDelay);
-        float dmix = mixSmoothed.getNextValue();
-        y = y * (1.0f - dmix) + delayed * dmix;
+        FloatType dmix = mixSmoothed.getNextValue();
+        return x * (1 - dmix) + delayed * dmix;
+    }
 
-        // Simple soft clip
-        y = std::tanh(y * compMakeup * 1.2f);
+    // Runs fn over every sample, at the oversampled rate when a factor is selected
+    template <typename Fn>
+    void processNonlinear(juce::dsp::AudioBlock<FloatType>& block, juce::dsp::Oversampling<FloatType>* os, Fn&& fn)
+    {
+        auto run = [&fn](juce::dsp::AudioBlock<FloatType> b)
+        {
+            for (size_t ch = 0; ch < b.getNumChannels(); ++ch)
+            {
+                auto* d = b.getChannelPointer(ch);
+                for (size_t i = 0; i < b.getNumSamples(); ++i)
+                    d[i] = fn(d[i]);
+            }
+        };
+
+        if (os == nullptr)
+        {
+            run(block);
+            return;
+        }
 
-        return y;
+        run(os->processSamplesUp(block));
+        os->processSamplesDown(block);
     }
 
-    void processBlock(juce::AudioBuffer<float>& buffer)
+    void processBlock(juce::AudioBuffer<FloatType>& buffer)
     {
-        juce::dsp::AudioBlock<float> block(buffer);
-        chorus.process(juce::dsp::ProcessContextReplacing<float>(block));
-        reverb.process(juce::dsp::ProcessContextReplacing<float>(block));
+        juce::dsp::AudioBlock<FloatType> block(buffer);
+        const int n = buffer.getNumSamples();
+        if (chorusReady.load()) chorus.process(buffer);
+        if (reverbReady.load())
+        {
+            processReverb(buffer);
+            reverbQuiet = countQuiet(reverbQuiet, (float) buffer.getMagnitude(0, n), n);
+        }
+
+        // Bitcrusher (mid-tread staircase, so silence stays at zero). When oversampled it
+        // always runs, so the reported latency doesn't depend on the crush amount.
+        if (crushSteps > 1)
+        {
+            FloatType step = 2 / crushSteps;
+            processNonlinear(block, crushOS[osIndex].get(),
+                             [step](FloatType x){ return std::round(x / step) * step; });
+        }
+        else if (osIndex > 0)
+        {
+            processNonlinear(block, crushOS[osIndex].get(), [](FloatType x){ return x; });
+        }
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        if (delayReady.load())
         {
-            auto* data = buffer.getWritePointer(ch);
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-                data[i] = processSample(ch, data[i]);
+            delayLine.setDelay((float) delaySamples);
+            delayPeak = 0.0f;
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                auto* data = buffer.getWritePointer(ch);
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    data[i] = processSample(ch, data[i]);
+            }
+            delayQuiet = countQuiet(delayQuiet, delayPeak, n);
         }
 
+        // Simple soft clip
+        FloatType clipGain = compMakeup * (FloatType) 1.2;
+        const float preClipPeak = (float) (buffer.getMagnitude(0, n) * clipGain);
+        const auto& sat = TanhTable::get();
+        processNonlinear(block, clipOS[osIndex].get(),
+                         [clipGain, &sat](FloatType x){ return sat(x * clipGain); });
+
         // Simple limiter if enabled
         if (limitOn)
         {
@@ -104,20 +232,119 @@ struct FXChain
             {
                 auto* d = buffer.getWritePointer(ch);
                 for (int i = 0; i < buffer.getNumSamples(); ++i)
-                    d[i] = juce::jlimit(-0.89f, 0.89f, d[i]);
+                    d[i] = juce::jlimit((FloatType) -0.89, (FloatType) 0.89, d[i]);
+            }
+        }
+
+        const float outPeak = (float) buffer.getMagnitude(0, n);
+        outputQuiet = countQuiet(outputQuiet, outPeak, n);
+
+        // How far the soft clip + limiter pulled the peak below plain makeup gain
+        gainReductionDb = preClipPeak > silenceThreshold
+                        ? juce::jmin(0.0f, juce::Decibels::gainToDecibels(outPeak / preClipPeak))
+                        : 0.0f;
+    }
+
+    void processReverb(juce::AudioBuffer<FloatType>& buffer)
+    {
+        if constexpr (std::is_same_v<FloatType, float>)
+        {
+            juce::dsp::AudioBlock<float> block(buffer);
+            reverb.process(juce::dsp::ProcessContextReplacing<float>(block));
+        }
+        else
+        {
+            const int n = buffer.getNumSamples();
+            const int numChannels = juce::jmin(buffer.getNumChannels(), reverbScratch.getNumChannels());
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* src = buffer.getReadPointer(ch);
+                auto* dst = reverbScratch.getWritePointer(ch);
+                for (int i = 0; i < n; ++i)
+                    dst[i] = (float) src[i];
+            }
+
+            auto wet = juce::dsp::AudioBlock<float>(reverbScratch).getSubsetChannelBlock(0, (size_t) numChannels)
+                                                                 .getSubBlock(0, (size_t) n);
+            reverb.process(juce::dsp::ProcessContextReplacing<float>(wet));
+
+            for (int i = 0; i < n; ++i)
+            {
+                const FloatType dry = reverbDry.getNextValue();
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* d = buffer.getWritePointer(ch);
+                    d[i] = d[i] * dry + (FloatType) reverbScratch.getSample(ch, i);
+                }
             }
         }
     }
 
-    juce::dsp::Chorus<float> chorus;
-    juce::dsp::Reverb reverb;
-    juce::dsp::DelayLine<float> delayLine { 96000 };
-    juce::SmoothedValue<float> mixSmoothed, widthSmoothed;
-    float delayFeedback = 0.3f;
+    //==============================================================================
+    // Sleep support: true once every stage has stayed below silenceThreshold for longer
+    // than it can ring, so the caller can stop running the chain until the next note.
+    bool tailsDecayed() const
+    {
+        const int sr = (int) spec.sampleRate;
+        return outputQuiet > sr / 20                                   // chorus, oversampler filters
+            && (! reverbReady.load() || reverbQuiet > sr / 5)          // 200 ms: comb + allpass path is ~75 ms
+            && (! delayReady.load()  || delayQuiet > delaySamples);    // one full pass through the line
+    }
+
+    // Called on the way to sleep. Chorus, reverb and delay only hold sub-threshold residue
+    // by then, so their (up to 1.5 MB) lines are not cleared on the audio thread.
+    void reset()
+    {
+        // Only the selected factor: others may still be under construction on the message
+        // thread, and setOversampling() resets a factor when it is selected anyway
+        if (osIndex > 0)
+        {
+            crushOS[osIndex]->reset();
+            clipOS[osIndex]->reset();
+        }
+    }
+
+    // Tail the host should expect after the last note, from the delay and reverb settings
+    static double getTailLengthSeconds(float delayTimeMs, float delayFb, float delayMix, float reverbMix)
+    {
+        double tail = reverbMix > 0.0f ? 1.5 : 0.0;
+        if (delayMix > 0.0f)
+        {
+            // Repeats until the feedback loop falls below the silence threshold
+            auto fb = juce::jlimit(0.01f, 0.95f, delayFb);
+            auto repeats = std::ceil(std::log(silenceThreshold) / std::log(fb));
+            tail = juce::jmax(tail, delayTimeMs * 0.001 * (repeats + 1.0));
+        }
+        return juce::jmin(tail, 30.0);
+    }
+
+    static int countQuiet(int quietSamples, float peak, int numSamples)
+    {
+        return peak < silenceThreshold ? juce::jmin(quietSamples + numSamples, 1 << 30) : 0;
+    }
+
+    ChorusEngine<FloatType> chorus;
+    juce::dsp::Reverb reverb;                    // float only, see processReverb()
+    juce::AudioBuffer<float> reverbScratch;      // double chain only
+    juce::SmoothedValue<FloatType> reverbDry;    // double chain only
+    static constexpr float reverbDryScale = 2.0f; // juce::Reverb's internal dry gain scale
+    juce::dsp::DelayLine<FloatType> delayLine;   // sized in prepareDelay()
+    juce::SmoothedValue<FloatType> mixSmoothed, widthSmoothed;
+    FloatType delayFeedback = (FloatType) 0.3;
     int delaySamples = 4800;
-    float crushSteps = 0.0f;
+    FloatType crushSteps = 0;
     bool limitOn = true;
-    juce::dsp::Compressor<float> comp;
-    float compMakeup = 1.0f;
+    juce::dsp::Compressor<FloatType> comp;
+    FloatType compMakeup = 1;
+    std::unique_ptr<juce::dsp::Oversampling<FloatType>> crushOS[3], clipOS[3]; // [0] stays null (1x)
+    int osIndex = 0;
+
+    juce::dsp::ProcessSpec spec { 0.0, 0, 0 };
+
+    static constexpr float silenceThreshold = 3.0e-5f; // about -90 dBFS
+    int reverbQuiet = 0, delayQuiet = 0, outputQuiet = 0;
+    float delayPeak = 0.0f;
+    float gainReductionDb = 0.0f;   // last block, for the editor meter
+    std::atomic<bool> chorusReady { false }, reverbReady { false }, delayReady { false };
     // (Width applied implicitly via stereo content in chorus/reverb/delay; for full M/S, expand here if desired)
 };
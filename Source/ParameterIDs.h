@@ -4,45 +4,49 @@
 
 namespace IDs {
     // Osc / Tone
-    const juce::String oscMorph   = "oscMorph";   // 0..1: Sine->Saw->Square
-    const juce::String subLevel   = "subLevel";   // 0..1
-    const juce::String noiseLevel = "noiseLevel"; // 0..1
-    const juce::String unison     = "unison";     // 1..7
-    const juce::String detune     = "detune";     // cents 0..50
-    const juce::String spread     = "spread";     // 0..1 stereo
-    const juce::String fmAmount   = "fmAmount";   // 0..1
-    const juce::String drive      = "drive";      // 0..1
+    inline constexpr const char* oscMorph   = "oscMorph";   // 0..1: Sine->Saw->Square
+    inline constexpr const char* subLevel   = "subLevel";   // 0..1
+    inline constexpr const char* noiseLevel = "noiseLevel"; // 0..1
+    inline constexpr const char* unison     = "unison";     // 1..7
+    inline constexpr const char* detune     = "detune";     // cents 0..50
+    inline constexpr const char* spread     = "spread";     // 0..1 stereo
+    inline constexpr const char* fmAmount   = "fmAmount";   // 0..1
+    inline constexpr const char* drive      = "drive";      // 0..1
 
     // Filter
-    const juce::String filterType = "filterType"; // 0=LP,1=BP,2=HP
-    const juce::String cutoff     = "cutoff";     // 20..20000
-    const juce::String resonance  = "resonance";  // 0.1..1.2
-    const juce::String filtEnvAmt = "filtEnvAmt"; // -1..1
+    inline constexpr const char* filterType = "filterType"; // 0=LP,1=BP,2=HP
+    inline constexpr const char* cutoff     = "cutoff";     // 20..20000
+    inline constexpr const char* resonance  = "resonance";  // 0.1..1.2
+    inline constexpr const char* filtEnvAmt = "filtEnvAmt"; // -1..1
 
     // Envelopes
-    const juce::String ampA = "ampA", ampD = "ampD", ampS = "ampS", ampR = "ampR";
-    const juce::String filA = "filA", filD = "filD", filS = "filS", filR = "filR";
+    inline constexpr const char* ampA = "ampA", *ampD = "ampD", *ampS = "ampS", *ampR = "ampR";
+    inline constexpr const char* filA = "filA", *filD = "filD", *filS = "filS", *filR = "filR";
 
     // FX
-    const juce::String chorusMix = "chorusMix";
-    const juce::String delayTime = "delayTime";
-    const juce::String delayFdbk = "delayFdbk";
-    const juce::String delayMix  = "delayMix";
-    const juce::String reverbMix = "reverbMix";
-    const juce::String crushAmt  = "crushAmt";
+    inline constexpr const char* chorusMix = "chorusMix";
+    inline constexpr const char* delayTime = "delayTime";
+    inline constexpr const char* delayFdbk = "delayFdbk";
+    inline constexpr const char* delayMix  = "delayMix";
+    inline constexpr const char* reverbMix = "reverbMix";
+    inline constexpr const char* crushAmt  = "crushAmt";
 
     // Master
-    const juce::String compAmt   = "compAmt";
-    const juce::String width     = "width";
-    const juce::String limitOn   = "limitOn";
+    inline constexpr const char* compAmt   = "compAmt";
+    inline constexpr const char* width     = "width";
+    inline constexpr const char* limitOn   = "limitOn";
+
+    // Quality
+    inline constexpr const char* osRealtime = "osRealtime"; // 0=1x,1=2x,2=4x while tracking
+    inline constexpr const char* osOffline  = "osOffline";  // 0=1x,1=2x,2=4x when bouncing
 
     // Macros
-    const juce::String macroBite  = "macroBite";
-    const juce::String macroBody  = "macroBody";
-    const juce::String macroAir   = "macroAir";
-    const juce::String macroSpace = "macroSpace";
+    inline constexpr const char* macroBite  = "macroBite";
+    inline constexpr const char* macroBody  = "macroBody";
+    inline constexpr const char* macroAir   = "macroAir";
+    inline constexpr const char* macroSpace = "macroSpace";
 
     // UI
-    const juce::String style     = "style";      // 0 Pop Gloss, 1 Trap 808, 2 R&B Silk
-    const juce::String newSauce  = "newSauce";   // button trigger
+    inline constexpr const char* style     = "style";      // 0 Pop Gloss, 1 Trap 808, 2 R&B Silk
+    inline constexpr const char* newSauce  = "newSauce";   // button trigger
 }
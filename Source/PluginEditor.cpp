@@ -17,6 +17,7 @@ RadioSauceSynthAudioProcessorEditor::RadioSauceSynthAudioProcessorEditor (RadioS
       width     (p.apvts, IDs::width,      "Width")
 {
     setLookAndFeel(&lnf);
+    addAndMakeVisible(background);
     setResizable(true, true);
     setSize (900, 520);
 
@@ -40,6 +41,20 @@ RadioSauceSynthAudioProcessorEditor::RadioSauceSynthAudioProcessorEditor (RadioS
     limiterAttach.reset(new juce::AudioProcessorValueTreeState::ButtonAttachment(processor.apvts, IDs::limitOn, limiterToggle));
     addAndMakeVisible(limiterToggle);
 
+    auto setUpQuality = [this](juce::Label& label, const juce::String& text, juce::ComboBox& box, const char* id,
+                               std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>& attach)
+    {
+        label.setText(text, juce::dontSendNotification);
+        label.setJustificationType(juce::Justification::centredLeft);
+        addAndMakeVisible(label);
+
+        box.addItemList({ "1x", "2x", "4x" }, 1);
+        addAndMakeVisible(box);
+        attach.reset(new juce::AudioProcessorValueTreeState::ComboBoxAttachment(processor.apvts, id, box));
+    };
+    setUpQuality(osRealtimeLabel, "Live OS", osRealtimeBox, IDs::osRealtime, osRealtimeAttach);
+    setUpQuality(osOfflineLabel, "Render OS", osOfflineBox, IDs::osOffline, osOfflineAttach);
+
     // Add components
     addAndMakeVisible(macroBite);
     addAndMakeVisible(macroBody);
@@ -54,33 +69,35 @@ RadioSauceSynthAudioProcessorEditor::RadioSauceSynthAudioProcessorEditor (RadioS
     addAndMakeVisible(compAmt);
     addAndMakeVisible(width);
 
+    addAndMakeVisible(scope);
+    addAndMakeVisible(meter);
+
+    // The background child covers every pixel, so nothing behind the editor needs repainting
+    setOpaque(true);
+
+    // The timer only drains the scope feed; static parts are never repainted by it
+    processor.scopeFeed.active = true;
     startTimerHz(30);
 }
 
-void RadioSauceSynthAudioProcessorEditor::paint (juce::Graphics& g)
+RadioSauceSynthAudioProcessorEditor::~RadioSauceSynthAudioProcessorEditor()
 {
-    auto r = getLocalBounds().toFloat();
-
-    // Background gradient with subtle grid
-    juce::Colour top = juce::Colour::fromRGB(18,18,24);
-    juce::Colour bottom = juce::Colour::fromRGB(10,10,14);
-    g.setGradientFill(juce::ColourGradient(top, r.getCentreX(), r.getY(), bottom, r.getCentreX(), r.getBottom(), false));
-    g.fillAll();
-
-    // Neon frame
-    g.setColour(juce::Colour::fromRGB(80,180,255).withAlpha(0.35f));
-    g.drawRoundedRectangle(r.reduced(6), 16.0f, 4.0f);
-
-    // Section titles
-    g.setColour(juce::Colours::white.withAlpha(0.85f));
-    g.setFont(juce::Font(16.0f, juce::Font::bold));
-    g.drawFittedText("STYLE", 20, 60, 100, 20, juce::Justification::left, 1);
-    g.drawFittedText("MACROS", 20, 130, 100, 20, juce::Justification::left, 1);
-    g.drawFittedText("TONE & FX", 20, 300, 120, 20, juce::Justification::left, 1);
+    processor.scopeFeed.active = false;
+    setLookAndFeel(nullptr);
+}
+
+void RadioSauceSynthAudioProcessorEditor::timerCallback()
+{
+    float points[ScopeView::numPoints];
+    while (int num = processor.scopeFeed.pull(points, ScopeView::numPoints))
+        scope.push(points, num);
+    meter.setLevels(processor.scopeFeed.takePeak(), processor.scopeFeed.takeGainReductionDb());
 }
 
 void RadioSauceSynthAudioProcessorEditor::resized()
 {
+    background.setBounds(getLocalBounds());
+
     auto area = getLocalBounds().reduced(16);
 
     // Top bar
@@ -120,4 +137,17 @@ void RadioSauceSynthAudioProcessorEditor::resized()
     delayMix.setBounds(juce::Rectangle<int>(16 + 0*cW, 320, cW-16, 120).reduced(8));
     compAmt.setBounds (juce::Rectangle<int>(16 + 1*cW, 320, cW-16, 120).reduced(8));
     width.setBounds    (juce::Rectangle<int>(16 + 2*cW, 320, cW-16, 120).reduced(8));
+
+    // Quality settings in the last cell of the second row
+    auto quality = juce::Rectangle<int>(16 + 3*cW, 320, cW-16, 120).reduced(8).withSizeKeepingCentre(cW-32, 64);
+    auto liveRow = quality.removeFromTop(32);
+    osRealtimeLabel.setBounds(liveRow.removeFromLeft(80));
+    osRealtimeBox.setBounds(liveRow.reduced(0, 4));
+    osOfflineLabel.setBounds(quality.removeFromLeft(80));
+    osOfflineBox.setBounds(quality.reduced(0, 4));
+
+    // Scope strip along the bottom, meters at its right
+    auto scopeArea = juce::Rectangle<int>(16, 448, getWidth()-32, getHeight()-448-16).reduced(8, 0);
+    meter.setBounds(scopeArea.removeFromRight(28));
+    scope.setBounds(scopeArea.withTrimmedRight(8));
 }
@@ -31,7 +31,7 @@ public:
         auto angle = rotaryStartAngle + sliderPosProportional * (rotaryEndAngle - rotaryStartAngle);
 
         // Glossy background ring
-        juce::Colour base = getColour(juce::Slider::rotarySliderFillColourId);
+        juce::Colour base = findColour(juce::Slider::rotarySliderFillColourId);
         juce::Colour glow = base.withAlpha(0.25f);
         g.setColour(glow);
         g.fillEllipse(cx - radius - 6.0f, cy - radius - 6.0f, (radius + 6.0f)*2, (radius + 6.0f)*2);
@@ -83,19 +83,127 @@ struct Knob : public juce::Component
     juce::AudioProcessorValueTreeState::SliderAttachment sliderAttachment;
 };
 
+// Gradient, frame and section titles. Buffered to an image, which JUCE keeps at the
+// display's pixel scale, so it is only redrawn on resize or a scale change.
+struct EditorBackground : public juce::Component
+{
+    EditorBackground()
+    {
+        setOpaque(true);
+        setInterceptsMouseClicks(false, false);
+        setBufferedToImage(true);
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+
+        // Background gradient with subtle grid
+        juce::Colour top = juce::Colour::fromRGB(18,18,24);
+        juce::Colour bottom = juce::Colour::fromRGB(10,10,14);
+        g.setGradientFill(juce::ColourGradient(top, r.getCentreX(), r.getY(), bottom, r.getCentreX(), r.getBottom(), false));
+        g.fillAll();
+
+        // Neon frame
+        g.setColour(juce::Colour::fromRGB(80,180,255).withAlpha(0.35f));
+        g.drawRoundedRectangle(r.reduced(6), 16.0f, 4.0f);
+
+        // Section titles
+        g.setColour(juce::Colours::white.withAlpha(0.85f));
+        g.setFont(juce::Font(16.0f, juce::Font::bold));
+        g.drawFittedText("STYLE", 20, 60, 100, 20, juce::Justification::left, 1);
+        g.drawFittedText("MACROS", 20, 130, 100, 20, juce::Justification::left, 1);
+        g.drawFittedText("TONE & FX", 20, 300, 120, 20, juce::Justification::left, 1);
+    }
+};
+
+// Output scope fed with decimated points from the audio thread; repaints only when new points arrive
+struct ScopeView : public juce::Component
+{
+    static constexpr int numPoints = 256;
+
+    void push(const float* data, int num)
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            points[(size_t) writePos] = data[i];
+            writePos = (writePos + 1) % numPoints;
+        }
+        if (num > 0) repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour(juce::Colour::fromRGB(24,24,28));
+        g.fillRoundedRectangle(r, 6.0f);
+
+        juce::Path p;
+        const float dx = r.getWidth() / (float) (numPoints - 1);
+        for (int i = 0; i < numPoints; ++i)
+        {
+            auto v = juce::jlimit(-1.0f, 1.0f, points[(size_t) ((writePos + i) % numPoints)]);
+            auto x = r.getX() + dx * (float) i;
+            auto y = r.getCentreY() - v * r.getHeight() * 0.45f;
+            if (i == 0) p.startNewSubPath(x, y); else p.lineTo(x, y);
+        }
+        g.setColour(juce::Colour::fromRGB(80,180,255));
+        g.strokePath(p, juce::PathStrokeType(1.5f));
+    }
+
+    std::array<float, numPoints> points {};
+    int writePos = 0;
+};
+
+// Peak + gain-reduction bars; repaints only when a level moves by a visible amount
+struct MeterView : public juce::Component
+{
+    void setLevels(float newPeak, float newGrDb)
+    {
+        // Peak falls back at ~20 dB/s at a 30 Hz refresh; GR releases the same way
+        auto peakDb = juce::jmax(juce::Decibels::gainToDecibels(newPeak, -60.0f), shownPeakDb - 0.7f);
+        auto grDb = juce::jmin(newGrDb, shownGrDb + 0.7f);
+        if (std::abs(peakDb - shownPeakDb) < 0.1f && std::abs(grDb - shownGrDb) < 0.1f) return;
+
+        shownPeakDb = peakDb;
+        shownGrDb = juce::jmin(0.0f, grDb);
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour(juce::Colour::fromRGB(24,24,28));
+        g.fillRoundedRectangle(r, 4.0f);
+
+        auto peakBar = r.removeFromLeft(r.getWidth() * 0.5f).reduced(2.0f);
+        auto grBar = r.reduced(2.0f);
+
+        auto peakFrac = juce::jmap(shownPeakDb, -60.0f, 0.0f, 0.0f, 1.0f);
+        g.setColour(shownPeakDb > -1.0f ? juce::Colours::orangered : juce::Colour::fromRGB(60,200,150));
+        g.fillRect(peakBar.removeFromBottom(peakBar.getHeight() * juce::jlimit(0.0f, 1.0f, peakFrac)));
+
+        auto grFrac = juce::jlimit(0.0f, 1.0f, -shownGrDb / 12.0f);
+        g.setColour(juce::Colours::gold);
+        g.fillRect(grBar.removeFromTop(grBar.getHeight() * grFrac));
+    }
+
+    float shownPeakDb = -60.0f, shownGrDb = 0.0f;
+};
+
 class RadioSauceSynthAudioProcessorEditor  : public juce::AudioProcessorEditor, private juce::Timer
 {
 public:
     RadioSauceSynthAudioProcessorEditor (RadioSauceSynthAudioProcessor&);
-    ~RadioSauceSynthAudioProcessorEditor() override = default;
+    ~RadioSauceSynthAudioProcessorEditor() override;
 
-    void paint (juce::Graphics&) override;
     void resized() override;
 
 private:
-    void timerCallback() override { repaint(); }
+    void timerCallback() override;
 
     RadioSauceSynthAudioProcessor& processor;
+    EditorBackground background;
     SauceLookAndFeel lnf;
 
     // Top bar
@@ -114,5 +222,14 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> limiterAttach;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> styleAttach;
 
+    // Oversampling for realtime playback and for offline bounces
+    juce::Label osRealtimeLabel, osOfflineLabel;
+    juce::ComboBox osRealtimeBox, osOfflineBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> osRealtimeAttach, osOfflineAttach;
+
+    // Output scope + meters
+    ScopeView scope;
+    MeterView meter;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RadioSauceSynthAudioProcessorEditor)
 };
@@ -7,18 +7,173 @@
 RadioSauceSynthAudioProcessor::RadioSauceSynthAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties().withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-       apvts(*this, nullptr, "PARAMS", createLayout())
+       apvts(*this, nullptr, "PARAMS", createLayout()),
+       synth(apvts)
 #endif
 {
-    for (int i = 0; i < 8; ++i)
-        synth.addVoice (new SynthVoice(apvts));
-    synth.addSound (new SynthSound());
+    // FX buffers and oversamplers are allocated on first enable: straight away when a mix
+    // parameter changes, with the timer as a fallback for anything a listener misses
+    for (auto id : { IDs::chorusMix, IDs::reverbMix, IDs::delayMix })
+        apvts.addParameterListener(id, this);
+
+    startTimerHz(10);
+}
+
+RadioSauceSynthAudioProcessor::~RadioSauceSynthAudioProcessor()
+{
+    for (auto id : { IDs::chorusMix, IDs::reverbMix, IDs::delayMix })
+        apvts.removeParameterListener(id, this);
+
+    stopTimer();
+    cancelPendingUpdate();
 }
 
 void RadioSauceSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    synth.setCurrentPlaybackSampleRate(sampleRate);
-    fx.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    const juce::ScopedLock sl(allocLock);
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+    isPrepared = true;
+
+    tables[0] = DSPTables::get(sampleRate);
+    osMidi.ensureSize(2048);
+
+    if (isUsingDoublePrecision())
+        preparePath(doublePath);
+    else
+        preparePath(floatPath);
+
+    setLatencySamples(oversamplingLatency.load());
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::preparePath(SignalPath<FloatType>& path)
+{
+    path.fx.prepare(currentSampleRate, currentBlockSize, getTotalNumOutputChannels());
+
+    // Re-prepare oversamplers that already exist (their buffers are reused unless the block grows)
+    for (int i = 1; i < 3; ++i)
+        if (path.osReady[i].load())
+            allocateOversampling(path, i);
+
+    allocatePendingResources(path);
+
+    osIndex = -1;
+    setOversampling(path, getOversamplingIndex(isNonRealtime()));
+}
+
+void RadioSauceSynthAudioProcessor::timerCallback()
+{
+    allocatePendingResources();
+
+    // An idle-time oversampling switch in processBlock changes the latency; report it from here
+    const int latency = oversamplingLatency.load();
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void RadioSauceSynthAudioProcessor::handleAsyncUpdate()
+{
+    allocatePendingResources();
+}
+
+void RadioSauceSynthAudioProcessor::parameterChanged(const juce::String&, float)
+{
+    // Automation can arrive on the audio thread; allocation is then handed to the message thread
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        allocatePendingResources();
+    else
+        triggerAsyncUpdate();
+}
+
+void RadioSauceSynthAudioProcessor::allocatePendingResources()
+{
+    const juce::ScopedLock sl(allocLock);
+    if (! isPrepared) return;
+
+    if (isUsingDoublePrecision())
+        allocatePendingResources(doublePath);
+    else
+        allocatePendingResources(floatPath);
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::allocatePendingResources(SignalPath<FloatType>& path)
+{
+    path.fx.allocateStages(apvts.getRawParameterValue(IDs::chorusMix)->load(),
+                           apvts.getRawParameterValue(IDs::reverbMix)->load(),
+                           apvts.getRawParameterValue(IDs::delayMix)->load());
+
+    for (auto offline : { false, true })
+    {
+        const int i = getOversamplingIndex(offline);
+        if (! path.osReady[i].load())
+            allocateOversampling(path, i);
+    }
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::allocateOversampling(SignalPath<FloatType>& path, int index)
+{
+    // Voices are summed to mono before the FX, so the synth oversampler only needs one channel
+    if (path.synthOS[index] == nullptr)
+        path.synthOS[index] = std::make_unique<juce::dsp::Oversampling<FloatType>>(1, (size_t) index,
+            juce::dsp::Oversampling<FloatType>::filterHalfBandPolyphaseIIR, true);
+
+    path.synthOS[index]->initProcessing((size_t) currentBlockSize);
+    tables[index] = DSPTables::get(currentSampleRate * (1 << index));
+    path.fx.allocateOversampling(index);
+    path.osReady[index] = true;
+}
+
+int RadioSauceSynthAudioProcessor::getOversamplingIndex(bool offline) const
+{
+    // Offline bounces get their own (usually higher) quality setting
+    auto id = offline ? IDs::osOffline : IDs::osRealtime;
+    return juce::jlimit(0, 2, (int) apvts.getRawParameterValue(id)->load());
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::setOversampling(SignalPath<FloatType>& path, int index)
+{
+    osIndex = index;
+    synth.prepare(*tables[osIndex], 1 << osIndex);
+
+    if (osIndex > 0)
+        path.synthOS[osIndex]->reset();
+
+    path.fx.setOversampling(osIndex);
+
+    // The IIR half-band filters delay the signal; the host compensates once it is reported
+    oversamplingLatency = osIndex == 0 ? 0
+        : juce::roundToInt(path.synthOS[osIndex]->getLatencyInSamples() + path.fx.getLatencyInSamples());
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::renderSynthOversampled(SignalPath<FloatType>& path, juce::AudioBuffer<FloatType>& buffer,
+                                                           juce::MidiBuffer& midi)
+{
+    auto& os = *path.synthOS[osIndex];
+    const int factor = 1 << osIndex;
+    const int numSamples = buffer.getNumSamples();
+
+    // The input is silent; processSamplesUp just hands us the oversampled stage buffer to render into
+    juce::dsp::AudioBlock<FloatType> base(buffer.getArrayOfWritePointers(), 1, (size_t) numSamples);
+    auto up = os.processSamplesUp(base);
+    up.clear();
+
+    FloatType* upData = up.getChannelPointer(0);
+    juce::AudioBuffer<FloatType> upBuffer(&upData, 1, (int) up.getNumSamples());
+
+    osMidi.clear();
+    for (const auto m : midi)
+        osMidi.addEvent(m.getMessage(), m.samplePosition * factor);
+
+    synth.renderNextBlock(upBuffer, osMidi, 0, upBuffer.getNumSamples());
+    os.processSamplesDown(base);
+
+    for (int ch = 1; ch < buffer.getNumChannels(); ++ch)
+        buffer.copyFrom(ch, 0, buffer, 0, 0, numSamples);
 }
 
 bool RadioSauceSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -27,6 +182,19 @@ bool RadioSauceSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& l
 }
 
 void RadioSauceSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    process(floatPath, buffer, midi);
+}
+
+// 64-bit hosts call this directly instead of converting every block to float
+void RadioSauceSynthAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi)
+{
+    process(doublePath, buffer, midi);
+}
+
+template <typename FloatType>
+void RadioSauceSynthAudioProcessor::process(SignalPath<FloatType>& path, juce::AudioBuffer<FloatType>& buffer,
+                                            juce::MidiBuffer& midi)
 {
     juce::ScopedNoDenormals noDenormals;
     buffer.clear();
@@ -35,7 +203,34 @@ void RadioSauceSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     if (needNewSauce.exchange(false))
         randomizeSauce();
 
-    synth.renderNextBlock(buffer, midi, 0, buffer.getNumSamples());
+    // Offline renders can run far ahead of a starved message thread, so anything enabled
+    // since prepareToPlay is allocated here rather than skipped until the timer catches up
+    if (isNonRealtime())
+    {
+        const juce::ScopedLock sl(allocLock);
+        allocatePendingResources(path);
+    }
+
+    // Asleep: no voices and every FX tail has decayed, so a block costs the clear() above.
+    // Any incoming MIDI wakes the instance; the FX lines only hold sub-threshold residue.
+    if (asleep.load())
+    {
+        if (midi.isEmpty())
+            return;
+
+        asleep = false;
+    }
+
+    // Quality changes apply in prepareToPlay, or here once nothing is sounding: switching
+    // rate re-prepares the voices and changes the latency, which would cut held notes
+    const int wantedOs = getOversamplingIndex(isNonRealtime());
+    if (wantedOs != osIndex && path.osReady[wantedOs].load() && ! isAnyVoiceActive() && path.fx.tailsDecayed())
+        setOversampling(path, wantedOs);
+
+    if (osIndex == 0)
+        synth.renderNextBlock(buffer, midi, 0, buffer.getNumSamples());
+    else
+        renderSynthOversampled(path, buffer, midi);
 
     // FX / Master params
     auto chorusMix = apvts.getRawParameterValue(IDs::chorusMix)->load();
@@ -48,8 +243,34 @@ void RadioSauceSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     auto width     = apvts.getRawParameterValue(IDs::width)->load();
     bool limitOn   = apvts.getRawParameterValue(IDs::limitOn)->load() > 0.5f;
 
+    auto& fx = path.fx;
     fx.setParams(chorusMix, delayTime, delayFdbk, delayMix, reverbMix, crushAmt, compAmt, width, limitOn);
     fx.processBlock(buffer);
+    scopeFeed.push(buffer, fx.gainReductionDb);
+
+    if (! isAnyVoiceActive() && fx.tailsDecayed())
+    {
+        fx.reset();
+        if (osIndex > 0)
+            path.synthOS[osIndex]->reset();
+        asleep = true;
+    }
+}
+
+bool RadioSauceSynthAudioProcessor::isAnyVoiceActive() const
+{
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (synth.getVoice(i)->isVoiceActive())
+            return true;
+    return false;
+}
+
+double RadioSauceSynthAudioProcessor::getTailLengthSeconds() const
+{
+    return FXChain<float>::getTailLengthSeconds(apvts.getRawParameterValue(IDs::delayTime)->load(),
+                                                apvts.getRawParameterValue(IDs::delayFdbk)->load(),
+                                                apvts.getRawParameterValue(IDs::delayMix)->load(),
+                                                apvts.getRawParameterValue(IDs::reverbMix)->load());
 }
 
 void RadioSauceSynthAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -62,7 +283,10 @@ void RadioSauceSynthAudioProcessor::setStateInformation (const void* data, int s
 {
     auto v = juce::ValueTree::readFromData(data, (size_t) sizeInBytes);
     if (v.isValid())
+    {
         apvts.replaceState(v);
+        allocatePendingResources();
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout RadioSauceSynthAudioProcessor::createLayout()
@@ -109,6 +333,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout RadioSauceSynthAudioProcesso
     params.push_back(f(0,1,0.001, IDs::width));
     params.push_back(std::make_unique<juce::AudioParameterBool>(IDs::limitOn, IDs::limitOn, true));
 
+    // Quality settings change latency, so they are not automatable
+    const auto notAutomatable = juce::AudioParameterChoiceAttributes().withAutomatable(false);
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(IDs::osRealtime, IDs::osRealtime, juce::StringArray{"1x","2x","4x"}, 0, notAutomatable));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(IDs::osOffline,  IDs::osOffline,  juce::StringArray{"1x","2x","4x"}, 2, notAutomatable));
+
     params.push_back(f(0,1,0.001, IDs::macroBite));
     params.push_back(f(0,1,0.001, IDs::macroBody));
     params.push_back(f(0,1,0.001, IDs::macroAir));
@@ -2,15 +2,19 @@
 #pragma once
 #include <JuceHeader.h>
 #include "ParameterIDs.h"
-#include "SynthVoice.h"
-#include "SynthSound.h"
+#include "SauceSynth.h"
 #include "FXChain.h"
+#include "DSPTables.h"
+#include "ScopeFeed.h"
 
-class RadioSauceSynthAudioProcessor  : public juce::AudioProcessor
+class RadioSauceSynthAudioProcessor  : public juce::AudioProcessor,
+                                       private juce::Timer,
+                                       private juce::AsyncUpdater,
+                                       private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     RadioSauceSynthAudioProcessor();
-    ~RadioSauceSynthAudioProcessor() override = default;
+    ~RadioSauceSynthAudioProcessor() override;
 
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
@@ -18,6 +22,8 @@ public:
 
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -29,7 +35,7 @@ public:
     bool acceptsMidi() const override { return true; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override { return 1; }
@@ -44,19 +50,68 @@ public:
 
     // Access to parameters
     juce::AudioProcessorValueTreeState apvts;
-    juce::Synthesiser synth;
+    SauceSynth synth;
 
     // Public helpers for the editor
     void triggerNewSauce() { needNewSauce.store(true); }
     void setStyle(int styleIndex) { applyStyle(styleIndex); }
 
+    // Decimated output and meter levels for the editor
+    ScopeFeed scopeFeed;
+
+    // True while processBlock is skipping the synth and FX because everything is silent.
+    // JUCE 7 has no per-block silence flag for the wrappers, so hosts learn about the tail
+    // through getTailLengthSeconds(); tools and the editor can read this directly.
+    bool isAsleep() const { return asleep.load(); }
+
 private:
-    FXChain fx;
+    // FX and synth oversampling for one sample type. The host picks the precision
+    // before prepareToPlay, and only the path in use allocates anything.
+    template <typename FloatType>
+    struct SignalPath
+    {
+        FXChain<FloatType> fx;
+
+        // Synth oversampling: voices run at sampleRate * 2^osIndex, then get decimated
+        std::unique_ptr<juce::dsp::Oversampling<FloatType>> synthOS[3]; // [0] stays null (1x)
+        std::atomic<bool> osReady[3] { { true }, { false }, { false } };
+    };
+
+    SignalPath<float> floatPath;
+    SignalPath<double> doublePath;
+
     std::atomic<bool> needNewSauce { false };
+    std::atomic<bool> asleep { false };
+
+    // Shared lookup tables for the base rate and the 2x/4x oversampled rates
+    std::shared_ptr<const DSPTables> tables[3];
+
+    juce::MidiBuffer osMidi;
+    int osIndex = -1;
+    std::atomic<int> oversamplingLatency { 0 };   // samples at the host rate, for osIndex
+    double currentSampleRate = 44100.0;
+    int currentBlockSize = 512;
+
+    // Guards prepareToPlay against the message-thread allocation of FX stages and oversamplers
+    juce::CriticalSection allocLock;
+    bool isPrepared = false;
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createLayout();
     void applyStyle(int styleIndex);
     void randomizeSauce();
+    int getOversamplingIndex(bool offline) const;
+    void allocatePendingResources();
+    void timerCallback() override;
+    void handleAsyncUpdate() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    bool isAnyVoiceActive() const;
+
+    template <typename FloatType> void preparePath(SignalPath<FloatType>&);
+    template <typename FloatType> void allocatePendingResources(SignalPath<FloatType>&);
+    template <typename FloatType> void allocateOversampling(SignalPath<FloatType>&, int index);
+    template <typename FloatType> void setOversampling(SignalPath<FloatType>&, int index);
+    template <typename FloatType> void renderSynthOversampled(SignalPath<FloatType>&, juce::AudioBuffer<FloatType>&, juce::MidiBuffer&);
+    template <typename FloatType> void process(SignalPath<FloatType>&, juce::AudioBuffer<FloatType>&, juce::MidiBuffer&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RadioSauceSynthAudioProcessor)
 };
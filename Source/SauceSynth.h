@@ -0,0 +1,121 @@
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterIDs.h"
+#include "SynthVoice.h"
+#include "VoiceBank.h"
+
+// Synthesiser that renders every voice together: each voice writes its
+// oscillators into its lane, then the VoiceBank filters, drives and envelopes
+// all lanes with SIMD and sums them to mono. There is one bank per sample type;
+// the host's processing precision decides which one renderNextBlock() runs.
+class SauceSynth : public juce::Synthesiser
+{
+public:
+    explicit SauceSynth(juce::AudioProcessorValueTreeState& apvts)
+    {
+        auto raw = [&apvts](const char* id) { return apvts.getRawParameterValue(id); };
+        oscMorph = raw(IDs::oscMorph);   subLevel = raw(IDs::subLevel);
+        noiseLevel = raw(IDs::noiseLevel); fmAmount = raw(IDs::fmAmount);
+        drive = raw(IDs::drive);         filterType = raw(IDs::filterType);
+        cutoff = raw(IDs::cutoff);       resonance = raw(IDs::resonance);
+        envAmt = raw(IDs::filtEnvAmt);
+        ampA = raw(IDs::ampA); ampD = raw(IDs::ampD); ampS = raw(IDs::ampS); ampR = raw(IDs::ampR);
+        filA = raw(IDs::filA); filD = raw(IDs::filD); filS = raw(IDs::filS); filR = raw(IDs::filR);
+
+        for (int i = 0; i < LaneEnvelopes::numLanes; ++i)
+            addVoice(new SynthVoice(envelopes, i));
+        addSound(new SynthSound());
+    }
+
+    // t is built for the rate the voices render at, oversamplingFactor times the host rate
+    void prepare(const DSPTables& t, int oversamplingFactor)
+    {
+        setCurrentPlaybackSampleRate(t.sampleRate);
+
+        // White noise and random FM spread their power over the whole band, and the
+        // decimation filter keeps 1/factor of it: scale up to sound the same at any factor
+        randomScale = std::sqrt((float) oversamplingFactor);
+
+        floatBank.prepare(t, readBankParams<float>());
+        doubleBank.prepare(t, readBankParams<double>());
+        for (auto* v : voices)
+            static_cast<SynthVoice*>(v)->prepareToPlay(t);
+    }
+
+protected:
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override
+    {
+        renderLanes(floatBank, outputAudio, startSample, numSamples);
+    }
+
+    void renderVoices(juce::AudioBuffer<double>& outputAudio, int startSample, int numSamples) override
+    {
+        renderLanes(doubleBank, outputAudio, startSample, numSamples);
+    }
+
+private:
+    template <typename FloatType>
+    typename VoiceBank<FloatType>::Params readBankParams() const
+    {
+        typename VoiceBank<FloatType>::Params bp;
+        bp.amp = { ampA->load(), ampD->load(), ampS->load(), ampR->load() };
+        bp.fil = { filA->load(), filD->load(), filS->load(), filR->load() };
+        bp.filterMode = (int) filterType->load();
+        bp.cutoff = cutoff->load();
+        bp.resonance = resonance->load();
+        bp.envAmt = envAmt->load();
+        bp.drive = drive->load();
+        return bp;
+    }
+
+    template <typename FloatType>
+    void renderLanes(VoiceBank<FloatType>& bank, juce::AudioBuffer<FloatType>& outputAudio, int startSample, int numSamples)
+    {
+        bank.setParams(readBankParams<FloatType>());
+
+        const SynthVoice::SourceParams sp { oscMorph->load(), subLevel->load(),
+                                            noiseLevel->load() * randomScale, fmAmount->load() * randomScale };
+
+        while (numSamples > 0)
+        {
+            const int n = juce::jmin(numSamples, VoiceBank<FloatType>::maxChunk);
+            bool anyActive = false;
+
+            bank.clearSource(n);
+            for (auto* v : voices)
+            {
+                if (v->isVoiceActive())
+                {
+                    static_cast<SynthVoice*>(v)->renderSource(sp, bank, n);
+                    anyActive = true;
+                }
+            }
+
+            if (anyActive)
+            {
+                FloatType mono[VoiceBank<FloatType>::maxChunk];
+                bank.process(n, mono);
+                for (int ch = 0; ch < outputAudio.getNumChannels(); ++ch)
+                    outputAudio.addFrom(ch, startSample, mono, n);
+
+                // Free voices whose release has finished
+                for (int i = 0; i < voices.size(); ++i)
+                    if (voices.getUnchecked(i)->isVoiceActive() && ! envelopes.isLaneActive(i))
+                        voices.getUnchecked(i)->clearCurrentNote();
+            }
+
+            startSample += n;
+            numSamples -= n;
+        }
+    }
+
+    LaneEnvelopes envelopes;
+    VoiceBank<float> floatBank { envelopes };
+    VoiceBank<double> doubleBank { envelopes };
+    float randomScale = 1.0f;
+
+    std::atomic<float>* oscMorph = nullptr, * subLevel = nullptr, * noiseLevel = nullptr, * fmAmount = nullptr;
+    std::atomic<float>* drive = nullptr, * filterType = nullptr, * cutoff = nullptr, * resonance = nullptr, * envAmt = nullptr;
+    std::atomic<float>* ampA = nullptr, * ampD = nullptr, * ampS = nullptr, * ampR = nullptr;
+    std::atomic<float>* filA = nullptr, * filD = nullptr, * filS = nullptr, * filR = nullptr;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Audio thread -> editor feed for the output scope and meters. The audio thread
+// pushes decimated scope points into a single-producer/single-consumer FIFO and
+// publishes peak and gain reduction through atomics; nothing locks or allocates.
+// Pushing is skipped while no editor is listening.
+struct ScopeFeed
+{
+    static constexpr int decimation = 16;   // output samples per scope point
+    static constexpr int fifoSize = 4096;
+
+    // Audio thread
+    template <typename FloatType>
+    void push(const juce::AudioBuffer<FloatType>& buffer, float gainReductionDb)
+    {
+        if (! active.load()) return;
+
+        const int numSamples = buffer.getNumSamples();
+        const int numChannels = buffer.getNumChannels();
+        if (numChannels == 0) return;
+
+        float points[fifoSize / decimation];
+        int numPoints = 0;
+        float blockPeak = 0.0f;
+
+        // Keep the sample with the largest magnitude of each bucket, sign included
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float s = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                s += (float) buffer.getSample(ch, i);
+            s /= (float) numChannels;
+
+            blockPeak = juce::jmax(blockPeak, std::abs(s));
+            if (std::abs(s) >= std::abs(bucketValue)) bucketValue = s;
+
+            if (++bucketCount == decimation)
+            {
+                if (numPoints < (int) std::size(points))
+                    points[numPoints++] = bucketValue;
+                bucketCount = 0;
+                bucketValue = 0.0f;
+            }
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numPoints, start1, size1, start2, size2);
+        std::copy(points, points + size1, scopeData + start1);
+        std::copy(points + size1, points + size1 + size2, scopeData + start2);
+        fifo.finishedWrite(size1 + size2);
+
+        peak.store(juce::jmax(peak.load(), blockPeak));
+        gainReduction.store(juce::jmin(gainReduction.load(), gainReductionDb));
+    }
+
+    // Message thread: copies up to maxPoints of the oldest pending points into dest
+    int pull(float* dest, int maxPoints)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(maxPoints, start1, size1, start2, size2);
+        std::copy(scopeData + start1, scopeData + start1 + size1, dest);
+        std::copy(scopeData + start2, scopeData + start2 + size2, dest + size1);
+        fifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    // Message thread: peak / gain reduction since the last call
+    float takePeak()            { return peak.exchange(0.0f); }
+    float takeGainReductionDb() { return gainReduction.exchange(0.0f); }
+
+    std::atomic<bool> active { false };
+
+private:
+    juce::AbstractFifo fifo { fifoSize };
+    float scopeData[fifoSize] {};
+    std::atomic<float> peak { 0.0f }, gainReduction { 0.0f };
+
+    // Audio-thread-only decimation state
+    int bucketCount = 0;
+    float bucketValue = 0.0f;
+};
@@ -0,0 +1,307 @@
+#pragma once
+#include <JuceHeader.h>
+#include "DSPTables.h"
+
+// Linear ADSR with the same segments as juce::ADSR, but advanced a whole
+// control block at a time. Rates are shared by every lane of the bank.
+struct LaneEnvelope
+{
+    enum class State { idle, attack, decay, sustain, release };
+
+    struct Rates
+    {
+        void set(const juce::ADSR::Parameters& p, double sr)
+        {
+            sustain = p.sustain;
+            attack  = p.attack > 0.0f ? (float) (1.0 / (p.attack * sr)) : -1.0f;
+            decay   = p.decay  > 0.0f ? (float) ((1.0f - p.sustain) / (p.decay * sr)) : -1.0f;
+            releaseSamples = (float) (p.release * sr);
+        }
+
+        float attack = -1.0f, decay = -1.0f, sustain = 1.0f, releaseSamples = 0.0f;
+    };
+
+    void noteOn(const Rates& r)
+    {
+        if (r.attack > 0.0f)     state = State::attack;
+        else if (r.decay > 0.0f) { value = 1.0f; state = State::decay; }
+        else                     { value = r.sustain; state = State::sustain; }
+    }
+
+    void noteOff(const Rates& r)
+    {
+        if (state == State::idle) return;
+
+        if (r.releaseSamples > 0.0f)
+        {
+            releaseRate = value / r.releaseSamples;
+            state = State::release;
+        }
+        else
+        {
+            reset();
+        }
+    }
+
+    void reset() { value = 0.0f; state = State::idle; }
+    bool isActive() const { return state != State::idle; }
+
+    // Steps n samples ahead, crossing segment boundaries exactly, and returns the new value
+    float advance(int n, const Rates& r)
+    {
+        while (n > 0)
+        {
+            switch (state)
+            {
+                case State::idle:
+                    return value = 0.0f;
+
+                case State::attack:
+                {
+                    auto steps = r.attack > 0.0f ? juce::jmax(0, (int) std::ceil((1.0f - value) / r.attack)) : 0;
+                    if (steps > n) return value += r.attack * (float) n;
+                    n -= steps;
+                    value = 1.0f;
+                    state = r.decay > 0.0f ? State::decay : State::sustain;
+                    break;
+                }
+
+                case State::decay:
+                {
+                    auto steps = r.decay > 0.0f ? juce::jmax(0, (int) std::ceil((value - r.sustain) / r.decay)) : 0;
+                    if (steps > n) return value -= r.decay * (float) n;
+                    n -= steps;
+                    state = State::sustain;
+                    break;
+                }
+
+                case State::sustain:
+                    return value = r.sustain;
+
+                case State::release:
+                {
+                    auto steps = releaseRate > 0.0f ? juce::jmax(0, (int) std::ceil(value / releaseRate)) : 0;
+                    if (steps > n) return value -= releaseRate * (float) n;
+                    reset();
+                    return value;
+                }
+            }
+        }
+        return value;
+    }
+
+    State state = State::idle;
+    float value = 0.0f, releaseRate = 0.0f;
+};
+
+// Note state of every lane. Envelopes run at control rate in float whatever the
+// sample type, so the float and double banks share one set and a voice only
+// talks to this.
+struct LaneEnvelopes
+{
+    static constexpr int numLanes = 8;
+
+    void setRates(const juce::ADSR::Parameters& ampParams, const juce::ADSR::Parameters& filParams, double sr)
+    {
+        ampRates.set(ampParams, sr);
+        filRates.set(filParams, sr);
+    }
+
+    void noteOn(int lane)  { amp[lane].noteOn(ampRates); fil[lane].noteOn(filRates); }
+    void noteOff(int lane) { amp[lane].noteOff(ampRates); fil[lane].noteOff(filRates); }
+    void kill(int lane)    { amp[lane].reset(); fil[lane].reset(); }
+    bool isLaneActive(int lane) const { return amp[lane].isActive(); }
+
+    void reset()
+    {
+        for (int l = 0; l < numLanes; ++l)
+            kill(l);
+    }
+
+    LaneEnvelope amp[numLanes], fil[numLanes];
+    LaneEnvelope::Rates ampRates, filRates;
+};
+
+// Filter, drive and amp state for every voice, stored voice-interleaved so
+// one SIMD register advances the SVFs of several voices in lock-step. The
+// recursion of a single SVF cannot be vectorised; across voices it can.
+//
+// Voices write their oscillator output into source() (sample-major, one column
+// per lane), then process() filters, drives and envelopes all lanes and sums
+// them to mono. Envelopes and cutoff run at control rate (one step per chunk)
+// and are ramped linearly across the chunk.
+//
+// Instantiated for float and double: a double register holds half as many
+// lanes, so the double bank runs twice the registers over the same voices.
+template <typename FloatType>
+struct VoiceBank
+{
+    using Vec = juce::dsp::SIMDRegister<FloatType>;
+
+    static constexpr int numLanes = LaneEnvelopes::numLanes;
+    static constexpr int laneWidth = (int) Vec::size();
+    static constexpr int numRegs = numLanes / laneWidth;
+    static constexpr int maxChunk = 32;
+    static_assert(numLanes % laneWidth == 0, "lanes must fill whole SIMD registers");
+
+    struct Params
+    {
+        juce::ADSR::Parameters amp, fil;
+        int filterMode = 0;   // 0 = LP, 1 = BP, 2 = HP
+        float cutoff = 1200.0f, resonance = 0.7f, envAmt = 0.0f, drive = 0.0f;
+    };
+
+    explicit VoiceBank(LaneEnvelopes& e) : env(e) {}
+
+    // Starts silent with the filter already at the current cutoff, so neither the
+    // first note after a prepare nor a quality switch sweeps up from 0 Hz
+    void prepare(const DSPTables& t, const Params& p)
+    {
+        tables = &t;
+        setParams(p);
+        env.reset();
+
+        const auto gRest = Vec::expand((FloatType) tables->cutoffToG(cutoffOct - envAmt * 0.5f));
+        for (int r = 0; r < numRegs; ++r)
+        {
+            s1[r] = s2[r] = amp[r] = Vec::expand(0);
+            g[r] = gRest;
+        }
+    }
+
+    void setParams(const Params& p)
+    {
+        env.setRates(p.amp, p.fil, tables->sampleRate);
+        filterMode = p.filterMode;
+        cutoffOct = std::log2(juce::jmax(p.cutoff, DSPTables::cutoffMinHz) / DSPTables::cutoffMinHz);
+        R2 = (FloatType) (1.0f / p.resonance);
+        envAmt = p.envAmt;
+        driveGain = (FloatType) (1.0f + p.drive * 6.0f);
+    }
+
+    // Interleaved oscillator input for the next chunk: sample i of lane l is source()[i * numLanes + l]
+    FloatType* source() { return src; }
+    void clearSource(int numSamples) { std::fill(src, src + numSamples * numLanes, FloatType()); }
+
+    // Renders numSamples (<= maxChunk) of the summed voices into out
+    void process(int numSamples, FloatType* out)
+    {
+        jassert(numSamples <= maxChunk);
+        const FloatType invN = FloatType(1) / (FloatType) numSamples;
+
+        // Control rate, per lane: envelopes -> cutoff -> g ramp; amp ramp
+        alignas(32) FloatType gEnd[numLanes], ampEnd[numLanes];
+        alignas(32) FloatType gStep[numLanes], ampStep[numLanes];
+        alignas(32) FloatType gNow[numLanes], ampNow[numLanes];
+        unsigned activeRegs = 0;
+
+        for (int r = 0; r < numRegs; ++r)
+        {
+            g[r].copyToRawArray(gNow + r * laneWidth);
+            amp[r].copyToRawArray(ampNow + r * laneWidth);
+        }
+
+        for (int l = 0; l < numLanes; ++l)
+        {
+            if (env.amp[l].isActive())
+                activeRegs |= 1u << (l / laneWidth);
+
+            const float fil = env.fil[l].advance(numSamples, env.filRates);
+            gEnd[l] = (FloatType) tables->cutoffToG(cutoffOct + envAmt * (fil - 0.5f));
+            ampEnd[l] = (FloatType) env.amp[l].advance(numSamples, env.ampRates);
+
+            gStep[l] = (gEnd[l] - gNow[l]) * invN;
+            ampStep[l] = (ampEnd[l] - ampNow[l]) * invN;
+        }
+
+        switch (filterMode)
+        {
+            case 1:  runFilter<1>(numSamples, activeRegs, gStep); break;
+            case 2:  runFilter<2>(numSamples, activeRegs, gStep); break;
+            default: runFilter<0>(numSamples, activeRegs, gStep); break;
+        }
+
+        // Drive: table lookup per value, over the contiguous chunk
+        const auto& sat = TanhTable::get();
+        for (int k = 0, end = numSamples * numLanes; k < end; ++k)
+            src[k] = sat(src[k] * driveGain);
+
+        // Amp envelope and sum across lanes
+        Vec ampStepV[numRegs];
+        for (int r = 0; r < numRegs; ++r)
+            ampStepV[r] = Vec::fromRawArray(ampStep + r * laneWidth);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto acc = Vec::expand(0);
+            for (int r = 0; r < numRegs; ++r)
+            {
+                if ((activeRegs & (1u << r)) == 0) continue;
+                amp[r] += ampStepV[r];
+                acc += Vec::fromRawArray(src + i * numLanes + r * laneWidth) * amp[r];
+            }
+            out[i] = acc.sum();
+        }
+
+        // Land exactly on the control values so ramps never drift
+        for (int r = 0; r < numRegs; ++r)
+        {
+            g[r] = Vec::fromRawArray(gEnd + r * laneWidth);
+            amp[r] = Vec::fromRawArray(ampEnd + r * laneWidth);
+        }
+    }
+
+private:
+    // TPT SVF, same response as juce::dsp::StateVariableTPTFilter, one voice per lane.
+    // g is ramped across the chunk and h is derived from it every sample, so the pair
+    // stays consistent through fast envelope sweeps. Filters the source in place.
+    template <int mode>
+    void runFilter(int numSamples, unsigned activeRegs, const FloatType* gStep)
+    {
+        const auto R2v = Vec::expand(R2);
+        const auto one = Vec::expand(1);
+        alignas(32) FloatType h[laneWidth];
+
+        for (int r = 0; r < numRegs; ++r)
+        {
+            if ((activeRegs & (1u << r)) == 0) continue;
+
+            auto gv = g[r], z1 = s1[r], z2 = s2[r];
+            const auto dg = Vec::fromRawArray(gStep + r * laneWidth);
+            FloatType* x = src + r * laneWidth;
+
+            for (int i = 0; i < numSamples; ++i, x += numLanes)
+            {
+                gv += dg;
+
+                // h = 1 / (1 + R2 g + g^2). SIMDRegister has no divide; this fixed-width,
+                // aligned loop compiles to one vector divide.
+                (one + (R2v + gv) * gv).copyToRawArray(h);
+                for (int k = 0; k < laneWidth; ++k)
+                    h[k] = FloatType(1) / h[k];
+                const auto hv = Vec::fromRawArray(h);
+
+                const auto hp = (Vec::fromRawArray(x) - (R2v + gv) * z1 - z2) * hv;
+                const auto bp = gv * hp + z1;
+                z1 = gv * hp + bp;
+                const auto lp = gv * bp + z2;
+                z2 = gv * bp + lp;
+
+                (mode == 0 ? lp : mode == 1 ? bp : hp).copyToRawArray(x);
+            }
+
+            s1[r] = z1;
+            s2[r] = z2;
+        }
+    }
+
+    LaneEnvelopes& env;
+    const DSPTables* tables = nullptr;
+
+    alignas(32) FloatType src[maxChunk * numLanes] {};
+    Vec s1[numRegs], s2[numRegs], g[numRegs], amp[numRegs];
+
+    int filterMode = 0;
+    float cutoffOct = 0.0f, envAmt = 0.0f;
+    FloatType R2 = 1, driveGain = 1;
+};
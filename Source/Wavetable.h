@@ -1,35 +1,34 @@
-
 #pragma once
 #include <JuceHeader.h>
+#include "DSPTables.h"
 
 struct MorphOsc
 {
-    void prepare(double sr) { sampleRate = sr; phase = 0.0; }
-    void setFrequency(float hz) { freq = hz; }
+    void prepare(const DSPTables& t) { tables = &t; phase = 0.0; }
+
+    // Base pitch in cycles per sample; also picks the band-limited mip for it
+    void setIncrement(double inc) { baseInc = this->inc = inc; mip = tables->mipForIncrement(inc); }
+    // Per-sample pitch offset around the base (FM), keeps the current mip
+    void setOffsetHz(float hz) { inc = baseInc + hz / tables->sampleRate; }
     void setMorph(float m) { morph = juce::jlimit(0.0f, 1.0f, m); }
 
-    inline float process()
+    template <typename FloatType = float>
+    inline FloatType process()
     {
-        auto inc = juce::MathConstants<double>::twoPi * freq / sampleRate;
         phase += inc;
-        if (phase > juce::MathConstants<double>::twoPi) phase -= juce::MathConstants<double>::twoPi;
-
-        // Base waves
-        float s = std::sin((float)phase);                     // sine
-        float saw = juce::jmap((float)phase, 0.0f, (float)juce::MathConstants<float>::twoPi, -1.0f, 1.0f); // naive saw
-        float sq = s >= 0.0f ? 1.0f : -1.0f;                  // naive square
-
-        // Crossfade Sine->Saw->Square
-        float m = morph * 2.0f;
-        float y;
-        if (m <= 1.0f) y = juce::jmap(m, 0.0f, 1.0f, s, saw);
-        else           y = juce::jmap(m - 1.0f, 0.0f, 1.0f, saw, sq);
+        if (phase >= 1.0) phase -= 1.0;
+        else if (phase < 0.0) phase += 1.0; // FM can push very low notes below 0 Hz
 
-        return y;
+        // Crossfade Sine->Saw->Square, reading only the two tables in use
+        auto m = (FloatType) morph * 2;
+        auto saw = DSPTables::read<FloatType>(tables->sawMip(mip), phase);
+        if (m <= 1) return juce::jmap(m, DSPTables::read<FloatType>(tables->sine.data(), phase), saw);
+        return juce::jmap(m - 1, saw, DSPTables::read<FloatType>(tables->squareMip(mip), phase));
     }
 
-    double sampleRate = 44100.0;
-    double phase = 0.0;
-    float freq = 100.0f;
+    const DSPTables* tables = nullptr;
+    double phase = 0.0;   // cycles, 0..1
+    double baseInc = 0.0, inc = 0.0;
+    int mip = 0;
     float morph = 0.0f;
 };
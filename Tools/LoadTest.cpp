@@ -0,0 +1,274 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+// Simulates a session of many instances in one process: N processors with the
+// three styles mixed, each playing its own generated chord progression, run
+// block by block in series like a single-threaded host would. Reports realtime
+// CPU per instance and for the whole session, the worst block, resident memory
+// per instance and (on Linux, where perf counters are allowed) cache misses.
+//
+// Usage: RadioSauceSynthLoadTest [--instances=40] [--rate=48000] [--block=256] [--seconds=10] [--double]
+
+namespace
+{
+    const char* const styleNames[] = { "Pop Gloss", "Trap 808", "R&B Silk" };
+
+    int getIntOption(const juce::ArgumentList& args, const juce::String& name, int fallback)
+    {
+        return args.containsOption(name) ? args.getValueForOption(name).getIntValue() : fallback;
+    }
+
+    // Resident set size of this process, 0 where /proc is not available
+    juce::int64 getResidentBytes()
+    {
+       #if defined(__linux__)
+        long pages = 0, resident = 0;
+        if (auto* f = std::fopen("/proc/self/statm", "r"))
+        {
+            if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+                resident = 0;
+            std::fclose(f);
+        }
+        return (juce::int64) resident * (juce::int64) sysconf(_SC_PAGESIZE);
+       #else
+        return 0;
+       #endif
+    }
+
+    // Hardware cache-miss counter for this thread. Containers and hosts with a strict
+    // perf_event_paranoid refuse it; the harness then just leaves the column out.
+    struct CacheMissCounter
+    {
+        CacheMissCounter()
+        {
+           #if defined(__linux__)
+            perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fd < 0)
+                unavailableReason = std::strerror(errno);
+           #else
+            unavailableReason = "perf counters need Linux";
+           #endif
+        }
+
+        ~CacheMissCounter()
+        {
+           #if defined(__linux__)
+            if (fd >= 0) close(fd);
+           #endif
+        }
+
+        bool isAvailable() const { return fd >= 0; }
+
+        juce::uint64 read() const
+        {
+            juce::uint64 count = 0;
+           #if defined(__linux__)
+            if (fd >= 0 && ::read(fd, &count, sizeof(count)) != (ssize_t) sizeof(count))
+                count = 0;
+           #endif
+            return count;
+        }
+
+        int fd = -1;
+        juce::String unavailableReason;
+    };
+
+    // Repeating four-chord progression, held for three quarters of each period. Start
+    // times are staggered per instance so note-ons don't all land in the same block.
+    struct MidiScript
+    {
+        MidiScript(int instance, int numInstances, int style, double sampleRate)
+            : period((juce::int64) (sampleRate * 2.0)),
+              length(period * 3 / 4),
+              offset(period * instance / juce::jmax(1, numInstances)),
+              bassOnly(style == 1)
+        {
+        }
+
+        void fill(juce::MidiBuffer& midi, juce::int64 blockStart, int numSamples) const
+        {
+            midi.clear();
+            const auto blockEnd = blockStart + numSamples;
+
+            // Chords whose note-on or note-off can fall inside this block
+            const auto first = juce::jmax((juce::int64) 0, (blockStart - offset - length) / period);
+            const auto last = (blockEnd - offset) / period;
+
+            for (auto k = first; k <= last; ++k)
+            {
+                const auto on = offset + k * period;
+                const auto off = on + length;
+                if (on >= blockStart && on < blockEnd)  addChord(midi, k, (int) (on - blockStart), true);
+                if (off >= blockStart && off < blockEnd) addChord(midi, k, (int) (off - blockStart), false);
+            }
+        }
+
+        void addChord(juce::MidiBuffer& midi, juce::int64 k, int pos, bool noteOn) const
+        {
+            static constexpr int roots[] = { 0, 5, 7, 3 };
+            static constexpr int minor7[] = { 0, 3, 7, 10 };
+
+            const int root = 48 + roots[k % 4];
+            const int numNotes = bassOnly ? 1 : 4;
+            for (int i = 0; i < numNotes; ++i)
+            {
+                const int note = bassOnly ? root - 12 : root + minor7[i];
+                midi.addEvent(noteOn ? juce::MidiMessage::noteOn(1, note, 0.8f)
+                                     : juce::MidiMessage::noteOff(1, note), pos);
+            }
+        }
+
+        juce::int64 period, length, offset;
+        bool bassOnly;
+    };
+
+    struct InstanceStats
+    {
+        double totalMs = 0.0, worstMs = 0.0;
+        juce::int64 memoryBytes = 0;
+        juce::uint64 cacheMisses = 0;
+        int asleepBlocks = 0;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args(argc, argv);
+
+    const int numInstances = juce::jmax(1, getIntOption(args, "--instances", 40));
+    const double sampleRate = (double) getIntOption(args, "--rate", 48000);
+    const int blockSize = juce::jmax(16, getIntOption(args, "--block", 256));
+    const int seconds = juce::jmax(1, getIntOption(args, "--seconds", 10));
+    const bool useDouble = args.containsOption("--double");
+
+    const int numBlocks = (int) (seconds * sampleRate / blockSize);
+    const double blockMs = 1000.0 * blockSize / sampleRate;
+
+    std::vector<std::unique_ptr<RadioSauceSynthAudioProcessor>> instances;
+    std::vector<MidiScript> scripts;
+    std::vector<InstanceStats> stats((size_t) numInstances);
+    instances.reserve((size_t) numInstances);
+    scripts.reserve((size_t) numInstances);
+
+    juce::AudioBuffer<float> floatBuffer(2, blockSize);
+    juce::AudioBuffer<double> doubleBuffer(2, blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(256);
+
+    // Setup: memory is the resident growth over construct + prepare + one block,
+    // so the first instance also carries the shared tables
+    const auto rssStart = getResidentBytes();
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        const auto rssBefore = getResidentBytes();
+
+        auto p = std::make_unique<RadioSauceSynthAudioProcessor>();
+        p->setStyle(i % 3);
+        p->setPlayConfigDetails(0, 2, sampleRate, blockSize);
+        p->setProcessingPrecision(useDouble ? juce::AudioProcessor::doublePrecision
+                                            : juce::AudioProcessor::singlePrecision);
+        p->prepareToPlay(sampleRate, blockSize);
+
+        midi.clear();
+        if (useDouble) p->processBlock(doubleBuffer, midi);
+        else           p->processBlock(floatBuffer, midi);
+
+        stats[(size_t) i].memoryBytes = getResidentBytes() - rssBefore;
+        scripts.emplace_back(i, numInstances, i % 3, sampleRate);
+        instances.push_back(std::move(p));
+    }
+
+    const auto rssSetup = getResidentBytes() - rssStart;
+
+    // Run: every instance renders each block in turn, like one host audio thread
+    CacheMissCounter cacheMisses;
+    double worstSessionBlockMs = 0.0, sessionMs = 0.0;
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        const auto blockStart = (juce::int64) b * blockSize;
+        double sessionBlockMs = 0.0;
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto& s = stats[(size_t) i];
+            scripts[(size_t) i].fill(midi, blockStart, blockSize);
+
+            const auto missesBefore = cacheMisses.read();
+            const auto t0 = juce::Time::getMillisecondCounterHiRes();
+
+            if (useDouble) instances[(size_t) i]->processBlock(doubleBuffer, midi);
+            else           instances[(size_t) i]->processBlock(floatBuffer, midi);
+
+            const auto ms = juce::Time::getMillisecondCounterHiRes() - t0;
+            s.cacheMisses += cacheMisses.read() - missesBefore;
+
+            s.totalMs += ms;
+            s.worstMs = juce::jmax(s.worstMs, ms);
+            s.asleepBlocks += instances[(size_t) i]->isAsleep() ? 1 : 0;
+            sessionBlockMs += ms;
+        }
+
+        sessionMs += sessionBlockMs;
+        worstSessionBlockMs = juce::jmax(worstSessionBlockMs, sessionBlockMs);
+    }
+
+    // Report
+    const double audioMs = numBlocks * blockMs;
+    auto kib = [](juce::int64 bytes) { return (double) bytes / 1024.0; };
+
+    std::printf("RadioSauceSynth load test: %d instances @ %.0f Hz, block %d (%.2f ms), %d s, %s\n",
+                numInstances, sampleRate, blockSize, blockMs, seconds, useDouble ? "double" : "float");
+    std::printf("  %4s  %-10s %7s %10s %9s %10s %12s\n",
+                "#", "style", "cpu %", "worst ms", "asleep %", "mem KiB", "cache miss");
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        const auto& s = stats[(size_t) i];
+        std::printf("  %4d  %-10s %7.2f %10.3f %9.1f %10.0f ",
+                    i, styleNames[i % 3], 100.0 * s.totalMs / audioMs, s.worstMs,
+                    100.0 * s.asleepBlocks / numBlocks, kib(s.memoryBytes));
+
+        if (cacheMisses.isAvailable()) std::printf("%12llu\n", (unsigned long long) s.cacheMisses);
+        else                           std::printf("%12s\n", "n/a");
+    }
+
+    juce::uint64 totalMisses = 0;
+    for (const auto& s : stats)
+        totalMisses += s.cacheMisses;
+
+    std::printf("  total cpu %.1f %% of one core realtime\n", 100.0 * sessionMs / audioMs);
+    std::printf("  worst session block %.3f ms (%.1f %% of the %.2f ms budget)\n",
+                worstSessionBlockMs, 100.0 * worstSessionBlockMs / blockMs, blockMs);
+
+    if (rssSetup > 0)
+        std::printf("  memory %.0f KiB total, %.0f KiB per instance\n", kib(rssSetup), kib(rssSetup) / numInstances);
+    else
+        std::printf("  memory n/a (needs /proc/self/statm)\n");
+
+    if (cacheMisses.isAvailable())
+        std::printf("  cache misses %llu (%.0f per instance block)\n", (unsigned long long) totalMisses,
+                    (double) totalMisses / ((double) numBlocks * numInstances));
+    else
+        std::printf("  cache misses n/a (%s)\n", cacheMisses.unavailableReason.toRawUTF8());
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <cstdio>
+
+// Measures what a host pays per instance when a session opens, in two orders:
+//
+//  - Host order: construct, prepareToPlay, setStateInformation with a saved
+//    style patch, first processBlock. This is how a session reload runs. Every
+//    mix parameter defaults to 0.5, so prepareToPlay allocates every FX stage
+//    before the saved patch can turn any of them off.
+//  - Style first: construct, setStyle, prepareToPlay, first processBlock, and a
+//    second prepareToPlay at the same size (which should reuse every
+//    allocation). This is the best case: stages the style leaves off are never
+//    allocated.
+//
+// Usage: RadioSauceSynthStartupBench [--instances=40] [--rate=48000] [--block=512]
+
+namespace
+{
+    struct Stat
+    {
+        void add(double ms) { total += ms; worst = juce::jmax(worst, ms); ++count; }
+        double mean() const { return count > 0 ? total / count : 0.0; }
+
+        double total = 0.0, worst = 0.0;
+        int count = 0;
+    };
+
+    int getIntOption(const juce::ArgumentList& args, const juce::String& name, int fallback)
+    {
+        return args.containsOption(name) ? args.getValueForOption(name).getIntValue() : fallback;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args(argc, argv);
+
+    const int numInstances = juce::jmax(1, getIntOption(args, "--instances", 40));
+    const double sampleRate = (double) getIntOption(args, "--rate", 48000);
+    const int blockSize = juce::jmax(16, getIntOption(args, "--block", 512));
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    auto now = [] { return juce::Time::getMillisecondCounterHiRes(); };
+
+    auto playFirstBlock = [&](RadioSauceSynthAudioProcessor& p, int i)
+    {
+        midi.clear();
+        midi.addEvent(juce::MidiMessage::noteOn(1, 48 + (i % 24), 0.8f), 0);
+        p.processBlock(buffer, midi);
+    };
+
+    // Saved state of each style, as a host would hand back on reload
+    juce::MemoryBlock styleStates[3];
+    for (int s = 0; s < 3; ++s)
+    {
+        auto p = std::make_unique<RadioSauceSynthAudioProcessor>();
+        p->setStyle(s);
+        p->getStateInformation(styleStates[s]);
+    }
+
+    std::vector<std::unique_ptr<RadioSauceSynthAudioProcessor>> instances;
+    instances.reserve((size_t) numInstances * 2);
+
+    // Host order
+    Stat hostConstruct, hostPrepare, hostSetState, hostFirstBlock;
+    const auto hostStart = now();
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto t0 = now();
+        auto p = std::make_unique<RadioSauceSynthAudioProcessor>();
+        auto t1 = now();
+
+        p->setPlayConfigDetails(0, 2, sampleRate, blockSize);
+        p->prepareToPlay(sampleRate, blockSize);
+        auto t2 = now();
+
+        const auto& state = styleStates[i % 3];
+        p->setStateInformation(state.getData(), (int) state.getSize());
+        auto t3 = now();
+
+        playFirstBlock(*p, i);
+        auto t4 = now();
+
+        hostConstruct.add(t1 - t0);
+        hostPrepare.add(t2 - t1);
+        hostSetState.add(t3 - t2);
+        hostFirstBlock.add(t4 - t3);
+        instances.push_back(std::move(p));
+    }
+
+    const auto hostMs = now() - hostStart;
+
+    // Style first
+    Stat construct, setStyle, prepare, firstBlock, reprepare;
+    const auto styleStart = now();
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        auto t0 = now();
+        auto p = std::make_unique<RadioSauceSynthAudioProcessor>();
+        auto t1 = now();
+
+        p->setStyle(i % 3);
+        auto t2 = now();
+
+        p->setPlayConfigDetails(0, 2, sampleRate, blockSize);
+        p->prepareToPlay(sampleRate, blockSize);
+        auto t3 = now();
+
+        playFirstBlock(*p, i);
+        auto t4 = now();
+
+        p->prepareToPlay(sampleRate, blockSize);
+        auto t5 = now();
+
+        construct.add(t1 - t0);
+        setStyle.add(t2 - t1);
+        prepare.add(t3 - t2);
+        firstBlock.add(t4 - t3);
+        reprepare.add(t5 - t4);
+        instances.push_back(std::move(p));
+    }
+
+    const auto styleMs = now() - styleStart;
+
+    auto print = [](const char* name, const Stat& s)
+    {
+        std::printf("    %-20s mean %8.3f ms   worst %8.3f ms\n", name, s.mean(), s.worst);
+    };
+
+    std::printf("RadioSauceSynth startup: %d instances @ %.0f Hz, block %d\n", numInstances, sampleRate, blockSize);
+
+    std::printf("  host order (construct, prepare, set state)\n");
+    print("construct", hostConstruct);
+    print("prepareToPlay", hostPrepare);
+    print("setStateInformation", hostSetState);
+    print("first block", hostFirstBlock);
+    std::printf("    total %.1f ms (%.3f ms per instance)\n", hostMs, hostMs / numInstances);
+
+    std::printf("  style first (best case)\n");
+    print("construct", construct);
+    print("setStyle", setStyle);
+    print("prepareToPlay", prepare);
+    print("first block", firstBlock);
+    print("re-prepare", reprepare);
+    std::printf("    total %.1f ms (%.3f ms per instance)\n", styleMs, styleMs / numInstances);
+    return 0;
+}